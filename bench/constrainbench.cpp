@@ -0,0 +1,51 @@
+// batch constraint benchmark: scaling of SplineBatch::constrain from 1 to 64 pooled threads, pool startup excluded
+
+#include "../source/spline.hpp" // curves & splines
+#include "../util/splinebatch.hpp" // batch constraints
+
+#include <stdio.h> // reporting
+#include <chrono> // timing
+#include <random> // spline generation
+
+#define BENCH_SPLINES 20000
+#define BENCH_MIN_POINTS 4
+#define BENCH_MAX_POINTS 40
+#define BENCH_MAX_THREADS 64
+
+int main(int argc, char *argv[]){
+	
+	// splines
+	std::vector<float> bezierCubicBasis = bezierBasis(2 + 2);
+	SplineType_Basis naturalSpline(std::vector<float>(bezierCubicBasis), 2, 2);
+	
+	// packed input
+	std::mt19937 random(1);
+	std::uniform_int_distribution<int> pointCount(BENCH_MIN_POINTS, BENCH_MAX_POINTS);
+	std::uniform_real_distribution<float> coordinate(-1.f, 1.f);
+	std::vector<float> input;
+	std::vector<std::size_t> inputOffsets;
+	for(int i = 0; i < BENCH_SPLINES; i++){
+		inputOffsets.push_back(input.size());
+		for(int p = pointCount(random) * 2; p > 0; p--) input.push_back(coordinate(random));
+	}
+	inputOffsets.push_back(input.size());
+	
+	// scaling
+	std::vector<float> reference;
+	double single = 0;
+	for(unsigned threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2){
+		std::vector<float> points(input);
+		std::vector<std::size_t> offsets(inputOffsets);
+		SplineBatch batch(threads);
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		batch.constrain(naturalSpline, points, offsets);
+		double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if(threads == 1){
+			reference = points;
+			single = time;
+		}
+		printf("%2u threads: %fs, speedup %.2fx, %s\n", threads, time, single / time, points == reference ? "deterministic" : "MISMATCH");
+	}
+	
+	return 0;
+}
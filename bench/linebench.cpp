@@ -0,0 +1,148 @@
+// line rendering benchmark: vertex-pulled joined strip, per join style, against per-segment instanced quads
+
+#include "../lib/window/window.hpp" // windowing
+#include "../lib/shader.hpp" // shader program
+
+#include "../util/filemanager.hpp" // shader source
+
+#include <stdio.h> // reporting
+#include <cmath> // curve generation
+
+#define BENCH_WIDTH 1280
+#define BENCH_HEIGHT 720
+#define BENCH_SAMPLES 1000000
+#define BENCH_FRAMES 50
+#define BENCH_THICKNESS .002f
+#define BENCH_MITER_LIMIT 4.f
+#define BENCH_ROUND_STEPS 6
+
+// previous per-segment line shader, instanced once per sample pair
+const char *instancedLineVertex = R"(
+#version 330 core
+
+layout (location = 0) in vec2 quad;
+layout (location = 1) in vec2 pos0;
+layout (location = 2) in vec2 dir0;
+layout (location = 3) in vec2 pos1;
+layout (location = 4) in vec2 dir1;
+
+uniform mat4 view_projection;
+uniform float line_thickness;
+
+void main(){
+	vec2 position = mix(pos0, pos1, (quad.x + 1) / 2);
+	vec2 direction = mix(dir0, dir1, (quad.x + 1) / 2);
+	vec2 joint = line_thickness * vec2(-direction.y, direction.x) * quad.y;
+	gl_Position = view_projection * vec4(position + joint, 0, 1);
+}
+)";
+
+struct Measure{
+	double milliseconds;
+	GLuint64 fragments;
+};
+
+Measure measure(Renderer const &renderer, Window const &window){ // gpu time & shaded fragments per frame
+	GLuint queries[2];
+	glGenQueries(2, queries);
+	Measure total{0, 0};
+	for(int frame = 0; frame < BENCH_FRAMES; frame++){
+		window.clear();
+		glBeginQuery(GL_TIME_ELAPSED, queries[0]);
+		glBeginQuery(GL_SAMPLES_PASSED, queries[1]);
+		renderer.display();
+		glEndQuery(GL_SAMPLES_PASSED);
+		glEndQuery(GL_TIME_ELAPSED);
+		GLuint64 time, fragments;
+		glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &time);
+		glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &fragments);
+		total.milliseconds += time / 1e6;
+		total.fragments += fragments;
+		window.swap();
+	}
+	glDeleteQueries(2, queries);
+	return Measure{ total.milliseconds / BENCH_FRAMES, total.fragments / BENCH_FRAMES };
+}
+
+int main(int argc, char *argv[]){
+
+	// window
+	Window window("Line benchmark", WindowGraphic, BENCH_WIDTH, BENCH_HEIGHT, 1000.f, 1000.f);
+	GLint textureLimit;
+	glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &textureLimit);
+	if(textureLimit < BENCH_SAMPLES){
+		printf("Texture buffer limit %i below %i samples\n", textureLimit, BENCH_SAMPLES);
+		return 1;
+	}
+
+	// dense spiral curve with unit directions
+	std::vector<float> samplePoints, sampleVectors;
+	for(int i = 0; i < BENCH_SAMPLES; i++){
+		float t = i / (float)BENCH_SAMPLES;
+		float angle = t * 400.f;
+		samplePoints.push_back(t * cos(angle));
+		samplePoints.push_back(t * sin(angle));
+		sampleVectors.push_back(-sin(angle));
+		sampleVectors.push_back(cos(angle));
+	}
+	std::array<float,16> identity{
+		1,0,0,0,
+		0,1,0,0,
+		0,0,1,0,
+		0,0,0,1};
+
+	// joined strip
+	Shader stripVertexShader(ShaderVertex, std::vector<const char*>{FileManager::get("shaders/lineVertex.glsl").c_str()});
+	Shader fragmentShader(ShaderFragment, std::vector<const char*>{FileManager::get("shaders/lineFragment.glsl").c_str()});
+	Program stripProgram(std::vector<Shader*>{ &stripVertexShader, &fragmentShader });
+	Buffer positionBuffer(BufferStatic, samplePoints.data(), sizeof(float) * samplePoints.size());
+	TextureBuffer positionTexture(positionBuffer, TextureFloat2);
+	stripProgram.setUniform("view_projection", DataMatrix4(identity, DataUnchanged));
+	stripProgram.setUniform("view_axis", DataFloat3(0, 0, 1));
+	stripProgram.setUniform("line_thickness", DataFloat(BENCH_THICKNESS));
+	stripProgram.setUniform("miter_limit", DataFloat(BENCH_MITER_LIMIT));
+	stripProgram.setUniform("sample_positions", DataInt(0));
+	stripProgram.setUniform("sample_count", DataInt(BENCH_SAMPLES));
+
+	// instanced quads
+	std::vector<float> quad{
+		-1,-1,
+		 1,-1,
+		 1, 1,
+		-1,-1,
+		 1, 1,
+		-1, 1
+	};
+	Shader instancedVertexShader(ShaderVertex, std::vector<const char*>{ instancedLineVertex });
+	Program instancedProgram(std::vector<Shader*>{ &instancedVertexShader, &fragmentShader });
+	Buffer quadBuffer(BufferStatic, quad.data(), sizeof(float) * quad.size());
+	Buffer directionBuffer(BufferStatic, sampleVectors.data(), sizeof(float) * sampleVectors.size());
+	Index quadIndex(quadBuffer, 2, IndexFloat, IndexUnchanged, sizeof(float) * 2, 0);
+	Index position0Index(positionBuffer, 2, IndexFloat, IndexUnchanged, sizeof(float) * 2, 0);
+	Index direction0Index(directionBuffer, 2, IndexFloat, IndexUnchanged, sizeof(float) * 2, 0);
+	Index position1Index(positionBuffer, 2, IndexFloat, IndexUnchanged, sizeof(float) * 2, (void*)(sizeof(float) * 2));
+	Index direction1Index(directionBuffer, 2, IndexFloat, IndexUnchanged, sizeof(float) * 2, (void*)(sizeof(float) * 2));
+	DrawInstancedArray instancedDraw(DrawTriangle, std::vector<Index*>{ &quadIndex }, quad.size() / 2,
+		std::vector<Index*>{ &position0Index, &direction0Index, &position1Index, &direction1Index }, BENCH_SAMPLES - 1);
+	instancedProgram.setUniform("view_projection", DataMatrix4(identity, DataUnchanged));
+	instancedProgram.setUniform("line_thickness", DataFloat(BENCH_THICKNESS));
+
+	// compare: miter & bevel need one outer joint point past the segment edges, round joins a fan
+	printf("%s\n%s\n", stripProgram.getErrorStatus().c_str(), instancedProgram.getErrorStatus().c_str());
+	Measure instanced = measure(Renderer(instancedProgram, instancedDraw), window);
+	double instancedVertices = (BENCH_SAMPLES - 1) * 6.0;
+	printf("instanced:    %fms, %.0f vertices (%.1f M/s), %llu fragments\n", instanced.milliseconds, instancedVertices, instancedVertices / instanced.milliseconds / 1e3, (unsigned long long)instanced.fragments);
+	const char *joins[] = { "miter", "bevel", "round" };
+	int joinSteps[] = { 3, 2, BENCH_ROUND_STEPS };
+	for(int join = 0; join < 3; join++){
+		DrawPulledArray stripDraw(DrawTriangleStrip, std::vector<TextureBuffer*>{ &positionTexture }, 2 * (joinSteps[join] + 2), BENCH_SAMPLES);
+		stripProgram.setUniform("line_join", DataInt(join));
+		stripProgram.setUniform("join_steps", DataInt(joinSteps[join]));
+		Measure strip = measure(Renderer(stripProgram, stripDraw), window);
+		double stripVertices = stripDraw.count;
+		printf("strip %s: %fms, %.0f vertices (%.1f M/s), %llu fragments, overdraw ratio (instanced / strip fragments) %.2f\n", joins[join], 
+			strip.milliseconds, stripVertices, stripVertices / strip.milliseconds / 1e3, (unsigned long long)strip.fragments, (double)instanced.fragments / strip.fragments);
+	}
+
+	return 0;
+}
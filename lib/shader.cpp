@@ -19,6 +19,24 @@ void Buffer::update(GLvoid const *data, GLsizeiptr size, GLintptr offset) const
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+// texture buffer
+
+TextureBuffer::TextureBuffer(Buffer const &b, TextureFormat f) : buffer{b.id}, format{f} {
+	glGenTextures(1, &id);
+	glBindTexture(GL_TEXTURE_BUFFER, id);
+	glTexBuffer(GL_TEXTURE_BUFFER, format, buffer);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+TextureBuffer::~TextureBuffer(){
+	glDeleteTextures(1, &id);
+}
+
+void TextureBuffer::bind(GLuint unit) const {
+	glActiveTexture(GL_TEXTURE0 + unit);
+	glBindTexture(GL_TEXTURE_BUFFER, id);
+}
+
 // index
 
 Index::Index(Buffer const &b,  GLint e, IndexType t, IndexNormal n, GLsizei s, GLvoid *o) : 
@@ -62,13 +80,21 @@ std::string Shader::getErrorStatus(){
 }
 
 Shader& Shader::operator=(Shader&& s){
+	if(id != GL_INVALID_ENUM) glDeleteShader(id);
 	id = std::move(s.id);
+	compileStatus = s.compileStatus;
 	s.id = GL_INVALID_ENUM;
 	return *this;
 }
 
 // data
 
+DataInt::DataInt(int d) : data{d} {}
+
+void DataInt::pass(GLint l) const {
+	glUniform1iv(l, 1, (GLint*)&data);
+}
+
 DataFloat::DataFloat(float d) : data{d} {}
 
 void DataFloat::pass(GLint l) const {
@@ -130,6 +156,15 @@ void Program::setUniform(const GLchar *tag, Data const &&d){
 	glUseProgram(0);
 }
 
+Program& Program::operator=(Program&& p){
+	glDeleteProgram(id);
+	id = p.id;
+	linkStatus = p.linkStatus;
+	uniformStatus = std::move(p.uniformStatus);
+	p.id = 0;
+	return *this;
+}
+
 // draw
 
 DrawArray::DrawArray(DrawMode m, std::vector<Index*> const &ivs, GLsizei n) : mode{m}, count{n} {
@@ -147,6 +182,8 @@ void DrawArray::recount(GLsizei n){
 	count = n;
 }
 
+DrawPulledArray::DrawPulledArray(DrawMode m, std::vector<TextureBuffer*> const &t, GLsizei v, GLsizei n) : DrawArray(m, std::vector<Index*>{}, v * n), textures{t}, elementVertices{v} {}
+
 DrawElements::DrawElements(DrawMode m, std::vector<Index*> const &ivs, Index const &ie, GLsizei n) : DrawArray(m, ivs, n), type{ie.type} {
 	glBindVertexArray(id);
 	ie.bind(GL_ELEMENT_ARRAY_BUFFER);
@@ -176,6 +213,15 @@ void DrawArray::call() const {
 	glDrawArrays(mode, 0, count);
 }
 
+void DrawPulledArray::call() const {
+	for(int i = 0; i < textures.size(); i++) textures[i]->bind(i);
+	DrawArray::call();
+}
+
+void DrawPulledArray::recountElements(GLsizei n){
+	count = elementVertices * n;
+}
+
 void DrawElements::call() const {
 	glDrawElements(mode, count, type, 0);
 }
@@ -190,10 +236,10 @@ void DrawInstancedElements::call() const {
 
 // renderer
 
-Renderer::Renderer(Program const &p, DrawArray const &d) : program{p.id}, vao{d.id}, draw{d} {}
+Renderer::Renderer(Program const &p, DrawArray const &d) : program{p}, vao{d.id}, draw{d} {}
 
 void Renderer::display() const {
-	glUseProgram(program);
+	glUseProgram(program.id);
 	glBindVertexArray(vao);
 	draw.call();
 	glBindVertexArray(0);
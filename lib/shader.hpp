@@ -12,6 +12,7 @@ struct Shader; // shader compilation
 struct Program; // program compilation & shader linking
 struct Index; // buffer indexing
 struct Buffer; // buffer data
+struct TextureBuffer; // buffer data fetched in shaders
 struct Data; // uniform data
 struct DrawArray; // drawing operation & attribute binding
 struct Renderer; // displaying
@@ -48,7 +49,14 @@ enum DataTranspose{
 enum DrawMode{
 	DrawPoint = GL_POINTS, 
 	DrawLine = GL_LINES, 
-	DrawTriangle = GL_TRIANGLES
+	DrawTriangle = GL_TRIANGLES, 
+	DrawTriangleStrip = GL_TRIANGLE_STRIP
+};
+
+enum TextureFormat{
+	TextureFloat = GL_R32F, 
+	TextureFloat2 = GL_RG32F, 
+	TextureFloat4 = GL_RGBA32F
 };
 
 // classes
@@ -60,6 +68,14 @@ struct Buffer{
 	void update(GLvoid const *data, GLsizeiptr size, GLintptr offset) const;
 };
 
+struct TextureBuffer{
+	GLuint id, buffer;
+	GLenum format;
+	TextureBuffer(Buffer const &b, TextureFormat f);
+	~TextureBuffer();
+	void bind(GLuint unit) const;
+};
+
 struct Index{
 	GLuint buffer;
 	GLint size;
@@ -86,6 +102,11 @@ struct Shader{
 struct Data{
 	virtual void pass(GLint l) const = 0;
 };
+struct DataInt : Data{
+	GLint data;
+	DataInt(int d);
+	void pass(GLint l) const;
+};
 struct DataFloat : Data{
 	GLfloat data;
 	DataFloat(float d);
@@ -116,6 +137,7 @@ struct Program{
 	~Program();
 	std::string getErrorStatus();
 	void setUniform(const GLchar *tag, Data const &&d);
+	Program& operator=(Program&& p);
 };
 
 struct DrawArray{
@@ -127,6 +149,13 @@ struct DrawArray{
 	virtual void call() const;
 	void recount(GLsizei n);
 };
+struct DrawPulledArray : DrawArray{ // vertices fetched from texture buffers by vertex id, a fixed number per element
+	std::vector<TextureBuffer*> textures;
+	GLsizei elementVertices;
+	DrawPulledArray(DrawMode m, std::vector<TextureBuffer*> const &t, GLsizei v, GLsizei n);
+	void call() const;
+	void recountElements(GLsizei n);
+};
 struct DrawElements : DrawArray{
 	GLenum type;
 	DrawElements(DrawMode m, std::vector<Index*> const &ivs, Index const &ie, GLsizei n);
@@ -147,7 +176,8 @@ struct DrawInstancedElements : DrawElements, DrawInstanced{
 };
 
 struct Renderer{
-	GLuint program, vao;
+	Program const &program; // followed across program reloads
+	GLuint vao;
 	DrawArray const &draw;
 	Renderer(Program const &p, DrawArray const &d);
 	void display() const;
@@ -5,8 +5,16 @@
 #include "source/spline.hpp" // curves & splines
 
 #include "util/filemanager.hpp" // shader source
+#include "util/filewatcher.hpp" // shader hot-reload
+#include "util/pointedits.hpp" // edit batching
+#include "util/samplecache.hpp" // sampled curve reuse
+#include "util/exporter.hpp" // curve output
 
 #include <stdio.h> // testing
+#include <algorithm> // shader replacement
+#include <chrono> // animation time
+#include <cmath> // animation looping
+#include <type_traits> // cached sample type
 
 // window constants
 #define WINDOW_WIDTH 640
@@ -18,14 +26,23 @@
 #define CAMERA_FOV 70.f
 #define PROJECTION_NEAR -1.f
 #define PROJECTION_FAR 1.f
+#define PERSPECTIVE_NEAR .01f
+#define PERSPECTIVE_FAR 100.f
+#define CAMERA_DISTANCE 2.f
+#define CAMERA_ROTATE_SENSITIVITY 2.f
 
 // shader constants
 #define MAX_VERTICES 10
 #define MAX_LINES 100
 #define POINT_RADIUS .03f
 #define LINE_THICKNESS .01f
+#define LINE_MITER_LIMIT 4.f
+#define LINE_JOIN 2 // 0 miter, 1 bevel, 2 round
+#define LINE_JOIN_STEPS 6 // outer joint points per sample
+#define LINE_JOIN_VERTICES (2 * (LINE_JOIN_STEPS + 2))
 #define VECTOR_THICKNESS .005f
 #define VECTOR_LENGTH .1f
+#define SHADER_RELOAD_INTERVAL 250
 
 // sampler constants
 #define SAMPLER_CONSTANT_RESOLUTION 5
@@ -36,6 +53,18 @@
 // curve constants
 #define CURVE_MAXIMUM_SAMPLES 20
 #define SPLINE_MAXIMUM_SAMPLES 8
+#define SAMPLE_CACHE_BUDGET (1 << 20)
+
+// export constants
+#define EXPORT_SVG "curve.svg"
+#define EXPORT_CSV "curve.csv"
+#define EXPORT_GCODE "curve.gcode"
+#define EXPORT_FEED_RATE 600.f
+#define EXPORT_GCODE_SCALE 100.f // millimetres per curve unit
+
+// animation constants
+#define MAX_KEYFRAMES 8
+#define ANIMATION_KEY_INTERVAL 1.f // seconds between keyframes
 
 // input constants
 #define INPUT_SELECT_RADIUS .075f
@@ -45,9 +74,69 @@
 enum ProgramInput{
 	InputPlace, InputRemove, // control points
 	InputSampler, // curve
-	InputSpline // spline
+	InputSpline, // spline
+	InputView, // camera
+	InputKeyframe, InputKeyframeClear, // animation
+	InputExport // output
+};
+
+// camera view: billboard axes for points, facing axis for vectors & lines
+void setView(Program &pointProgram, std::vector<Program*> const &facingPrograms, std::array<float,16> const &viewProjection, glm::mat3 const &basis){
+	pointProgram.setUniform("view_projection", DataMatrix4(viewProjection, DataUnchanged));
+	pointProgram.setUniform("view_right", DataFloat3(basis[0].x, basis[0].y, basis[0].z));
+	pointProgram.setUniform("view_up", DataFloat3(basis[1].x, basis[1].y, basis[1].z));
+	for(Program *program : facingPrograms){
+		program->setUniform("view_projection", DataMatrix4(viewProjection, DataUnchanged));
+		program->setUniform("view_axis", DataFloat3(basis[2].x, basis[2].y, basis[2].z));
+	}
+}
+
+glm::mat3 getViewBasis(Camera &camera){ // right, up & backward axes in world space
+	glm::mat4 view, projection, rotation;
+	glm::vec3 position;
+	camera.insertUniforms(view, projection, rotation, position);
+	return glm::transpose(glm::mat3(rotation));
+}
+
+// animation keyframe: control points at a track time, sampled once when keyed
+struct Keyframe{
+	float time;
+	std::vector<float> points;
 };
 
+// shader hot-reload
+struct ShaderReload{
+	std::string file;
+	ShaderType type;
+	Shader &shader;
+	Program &program;
+	std::vector<Shader*> shaders; // program's shaders
+};
+
+bool reloadShader(ShaderReload &reload, std::string const &source){ // old shader & program kept on failure
+	Shader shader(reload.type, std::vector<const char*>{ source.c_str() });
+	if(!shader.compileStatus){
+		printf("%s: %s\n", reload.file.c_str(), shader.getErrorStatus().c_str());
+		return false;
+	}
+	std::vector<Shader*> shaders(reload.shaders);
+	std::replace(shaders.begin(), shaders.end(), &reload.shader, &shader);
+	Program program(shaders);
+	if(!program.linkStatus){
+		printf("%s: %s\n", reload.file.c_str(), program.getErrorStatus().c_str());
+		return false;
+	}
+	reload.shader = std::move(shader);
+	reload.program = std::move(program);
+	return true;
+}
+
+// sampler total follows spline type
+void setSamplerTotal(CurveSampler &sampler, int spline){
+	if(spline == 0) sampler.setTotal(CURVE_MAXIMUM_SAMPLES);
+	else sampler.setTotal(SPLINE_MAXIMUM_SAMPLES);
+}
+
 void displayCurve(std::vector<Renderer*> const renderers, Window const &window){
 	window.clear();
 	for(int i = 0; i < renderers.size(); i++) renderers[i]->display();
@@ -93,7 +182,7 @@ int main(int argc, char *argv[]){
 	Window window("Splines", WindowGraphic, WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_PERSEC, INPUT_PERSEC);
 	InputBind input(window.getMouseMotionHandle(), window.getMousePositionHandle());
 	input.bindAll(std::vector<std::pair<int,WindowKey>>{
-		{InputSpline, KeyS}, {InputSampler, KeyC}}, window);
+		{InputSpline, KeyS}, {InputSampler, KeyC}, {InputView, KeyV}, {InputKeyframe, KeyK}, {InputKeyframeClear, KeyX}, {InputExport, KeyE}}, window);
 	input.bindAll(std::vector<std::pair<int,WindowButton>>{
 		{InputPlace, MouseLeftClick}, {InputRemove, MouseRightClick}}, window);
 	float viewport[2];
@@ -103,13 +192,28 @@ int main(int argc, char *argv[]){
 	CameraProjection projection(CameraOrthographic, CAMERA_FOV, PROJECTION_NEAR, PROJECTION_FAR);
 	std::array<float,16> projectionMatrix = projection.get(window.getAspectRatio());
 	
-	// shaders
-	Shader pointVertexShader(ShaderVertex, std::vector<const char*>{FileManager::get("shaders/pointVertex.glsl").c_str()});
-	Shader pointFragmentShader(ShaderFragment, std::vector<const char*>{FileManager::get("shaders/pointFragment.glsl").c_str()});
-	Shader vectorVertexShader(ShaderVertex, std::vector<const char*>{FileManager::get("shaders/vectorVertex.glsl").c_str()});
-	Shader vectorFragmentShader(ShaderFragment, std::vector<const char*>{FileManager::get("shaders/vectorFragment.glsl").c_str()});
-	Shader lineVertexShader(ShaderVertex, std::vector<const char*>{FileManager::get("shaders/lineVertex.glsl").c_str()});
-	Shader lineFragmentShader(ShaderFragment, std::vector<const char*>{FileManager::get("shaders/lineFragment.glsl").c_str()});
+	// 3D inspection camera
+	Camera camera(std::array<float,3>{ 0, 0, CAMERA_DISTANCE }, CAMERA_ROTATE_SENSITIVITY, 0);
+	CameraProjection perspective(CameraPerspective, CAMERA_FOV, PERSPECTIVE_NEAR, PERSPECTIVE_FAR);
+	perspective.set(camera, window.getAspectRatio());
+	bool isViewFree = false;
+	
+	// shaders: sources read concurrently, compiled on this thread
+	std::chrono::steady_clock::time_point loadStart = std::chrono::steady_clock::now();
+	std::vector<std::string> shaderFiles{
+		"shaders/pointVertex.glsl", "shaders/pointFragment.glsl", 
+		"shaders/vectorVertex.glsl", "shaders/vectorFragment.glsl", 
+		"shaders/lineVertex.glsl", "shaders/lineFragment.glsl"
+	};
+	std::vector<std::future<std::string>> shaderSources;
+	for(std::string const &file : shaderFiles) shaderSources.push_back(FileManager::load(file));
+	Shader pointVertexShader(ShaderVertex, std::vector<const char*>{shaderSources[0].get().c_str()});
+	Shader pointFragmentShader(ShaderFragment, std::vector<const char*>{shaderSources[1].get().c_str()});
+	Shader vectorVertexShader(ShaderVertex, std::vector<const char*>{shaderSources[2].get().c_str()});
+	Shader vectorFragmentShader(ShaderFragment, std::vector<const char*>{shaderSources[3].get().c_str()});
+	Shader lineVertexShader(ShaderVertex, std::vector<const char*>{shaderSources[4].get().c_str()});
+	Shader lineFragmentShader(ShaderFragment, std::vector<const char*>{shaderSources[5].get().c_str()});
+	printf("Loaded shaders in %fs\n", std::chrono::duration<float>(std::chrono::steady_clock::now() - loadStart).count());
 		
 	// renderer instance
 	std::vector<float> quad{
@@ -129,16 +233,13 @@ int main(int argc, char *argv[]){
 	Program pointProgram(std::vector<Shader*>{ &pointVertexShader, &pointFragmentShader });
 	DrawInstancedArray pointDraw(DrawTriangle, std::vector<Index*>{ &quadIndex }, quad.size() / 2, std::vector<Index*>{ &pointIndex }, splineInput.points.size() / 2);
 	
-	// line segment renderer
+	// line strip renderer: segment ends & joint fan per sample, positions fetched in shader; keyframe samples at MAX_LINES texel strides
 	Buffer linePositionBuffer(BufferStream, splineInput.samplePoints.data(), sizeof(float) * MAX_LINES * 2);
-	Buffer lineDirectionBuffer(BufferStream, splineInput.sampleVectors.data(), sizeof(float) * MAX_LINES * 2);
-	Index linePosition0Index(linePositionBuffer, 2, IndexFloat, IndexUnchanged, sizeof(float) * 2, 0);
-	Index lineDirection0Index(lineDirectionBuffer, 2, IndexFloat, IndexUnchanged, sizeof(float) * 2, 0);
-	Index linePosition1Index(linePositionBuffer, 2, IndexFloat, IndexUnchanged, sizeof(float) * 2, (void*)(sizeof(float) * 2));
-	Index lineDirection1Index(lineDirectionBuffer, 2, IndexFloat, IndexUnchanged, sizeof(float) * 2, (void*)(sizeof(float) * 2));
+	TextureBuffer linePositionTexture(linePositionBuffer, TextureFloat2);
+	Buffer keyframePositionBuffer(BufferStatic, 0, sizeof(float) * MAX_KEYFRAMES * MAX_LINES * 2);
+	TextureBuffer keyframePositionTexture(keyframePositionBuffer, TextureFloat2);
 	Program lineProgram(std::vector<Shader*>{ &lineVertexShader, &lineFragmentShader });
-	DrawInstancedArray lineDraw(DrawTriangle, std::vector<Index*>{ &quadIndex }, quad.size(), 
-		std::vector<Index*>{ &linePosition0Index, &lineDirection0Index, &linePosition1Index, &lineDirection1Index }, splineInput.samplePoints.size() / 2 - 1);
+	DrawPulledArray lineDraw(DrawTriangleStrip, std::vector<TextureBuffer*>{ &linePositionTexture, &keyframePositionTexture }, LINE_JOIN_VERTICES, splineInput.samplePoints.size() / 2);
 	
 	// vector renderer
 	Index vectorPosition0Index(pointBuffer, 2, IndexFloat, IndexUnchanged, sizeof(float) * 4, 0);
@@ -167,22 +268,74 @@ int main(int argc, char *argv[]){
 		0,1,0,0,
 		0,0,1,0,
 		0,0,0,1};
-	pointProgram.setUniform("view_projection", DataMatrix4(projectionMatrix, DataUnchanged));
-	pointProgram.setUniform("point_radius", DataFloat(POINT_RADIUS));
-	vectorProgram.setUniform("view_projection", DataMatrix4(projectionMatrix, DataUnchanged));
-	vectorProgram.setUniform("vector_thickness", DataFloat(VECTOR_THICKNESS));
-	vectorProgram.setUniform("vector_length", DataFloat(VECTOR_LENGTH));
-	lineProgram.setUniform("view_projection", DataMatrix4(projectionMatrix, DataUnchanged));
-	lineProgram.setUniform("line_thickness", DataFloat(LINE_THICKNESS));
+	std::vector<Program*> facingPrograms{ &vectorProgram, &lineProgram };
+	
+	// animation state: bracketing keyframes & fraction between them, kept across shader reloads
+	bool isAnimated = false;
+	int keyframeFirst = 0, keyframeNext = 0, keyframeSamples = 0;
+	float animationTime = 0;
+	auto setAnimation = [&](){
+		lineProgram.setUniform("is_animated", DataInt(isAnimated));
+		lineProgram.setUniform("keyframe_first", DataInt(keyframeFirst * MAX_LINES));
+		lineProgram.setUniform("keyframe_next", DataInt(keyframeNext * MAX_LINES));
+		lineProgram.setUniform("animation_time", DataFloat(animationTime));
+		lineProgram.setUniform("sample_count", DataInt(isAnimated ? keyframeSamples : splineInput.samplePoints.size() / 2));
+	};
+	auto setUniforms = [&](){ // reapplied after shader reloads
+		if(isViewFree) setView(pointProgram, facingPrograms, camera.getViewProjection(), getViewBasis(camera));
+		else setView(pointProgram, facingPrograms, projectionMatrix, glm::mat3(1));
+		pointProgram.setUniform("point_radius", DataFloat(POINT_RADIUS));
+		vectorProgram.setUniform("vector_thickness", DataFloat(VECTOR_THICKNESS));
+		vectorProgram.setUniform("vector_length", DataFloat(VECTOR_LENGTH));
+		lineProgram.setUniform("line_thickness", DataFloat(LINE_THICKNESS));
+		lineProgram.setUniform("miter_limit", DataFloat(LINE_MITER_LIMIT));
+		lineProgram.setUniform("line_join", DataInt(LINE_JOIN));
+		lineProgram.setUniform("join_steps", DataInt(LINE_JOIN_STEPS));
+		lineProgram.setUniform("sample_positions", DataInt(0));
+		lineProgram.setUniform("keyframe_positions", DataInt(1));
+		setAnimation();
+	};
+	setUniforms();
+	
+	// shader hot-reload
+	std::vector<ShaderReload> shaderReloads{
+		{ shaderFiles[0], ShaderVertex, pointVertexShader, pointProgram, { &pointVertexShader, &pointFragmentShader } }, 
+		{ shaderFiles[1], ShaderFragment, pointFragmentShader, pointProgram, { &pointVertexShader, &pointFragmentShader } }, 
+		{ shaderFiles[2], ShaderVertex, vectorVertexShader, vectorProgram, { &vectorVertexShader, &vectorFragmentShader } }, 
+		{ shaderFiles[3], ShaderFragment, vectorFragmentShader, vectorProgram, { &vectorVertexShader, &vectorFragmentShader } }, 
+		{ shaderFiles[4], ShaderVertex, lineVertexShader, lineProgram, { &lineVertexShader, &lineFragmentShader } }, 
+		{ shaderFiles[5], ShaderFragment, lineFragmentShader, lineProgram, { &lineVertexShader, &lineFragmentShader } }
+	};
+	FileWatcher shaderWatcher(shaderFiles, SHADER_RELOAD_INTERVAL);
 	
 	// first display
 	displayCurve(currentRenderers[0], window);
 	bool isDataOutdated = false;
+	bool isViewOutdated = false;
+	PointEdits edits;
+	std::vector<Keyframe> keyframes; // control point track
+	std::chrono::steady_clock::time_point animationStart;
+	typedef std::decay<decltype(splines[0]->computeSamples(splineInput.points, *samplers[0]))>::type CurveSamples;
+	SampleCache<CurveSamples> sampleCache(SAMPLE_CACHE_BUDGET); // sampler totals follow spline type, so the indices identify all parameters
+	bool isCacheReported = false;
 	
 	// loop
 	bool isRunning = true;
 	while(isRunning){
 		
+		// swap in changed shaders between frames
+		std::string changedFile, changedSource;
+		while(shaderWatcher.poll(changedFile, changedSource)){
+			for(ShaderReload &reload : shaderReloads){
+				if(reload.file != changedFile) continue;
+				std::chrono::steady_clock::time_point reloadStart = std::chrono::steady_clock::now();
+				if(!reloadShader(reload, changedSource)) continue;
+				setUniforms();
+				isViewOutdated = true;
+				printf("Reloaded %s in %fs\n", changedFile.c_str(), std::chrono::duration<float>(std::chrono::steady_clock::now() - reloadStart).count());
+			}
+		}
+		
 		// window behaviour
 		WindowState windowState;
 		while((windowState = window.get(), windowState) != WindowDefault){
@@ -202,8 +355,37 @@ int main(int argc, char *argv[]){
 		// input
 		if(window.cap(WindowInput)){
 			
+			// toggle 3D inspection view
+			if(input.getPress(InputView)){
+				isViewFree = !isViewFree;
+				if(splineInput.selectedPoint != -1){ // drop dragged point
+					edits.drop(splineInput.selectedPoint);
+					splineInput.setSelectedPoint(-1);
+				}
+				if(isViewFree){
+					float still[3] = { 0, 0, 0 };
+					camera.input(1, 0, 0, still, still); // pivot about origin
+					setView(pointProgram, facingPrograms, camera.getViewProjection(), getViewBasis(camera));
+				}
+				else setView(pointProgram, facingPrograms, projectionMatrix, glm::mat3(1));
+				isViewOutdated = true;
+				printf("Toggled view\n");
+			}
+			
+			// orbit inspection camera
+			if(isViewFree){
+				if(input.getHold(InputPlace)){
+					float still[3] = { 0, 0, 0 };
+					float turning[2];
+					input.getMouseMotion(turning);
+					camera.input(0, 1, 0, still, turning);
+					setView(pointProgram, facingPrograms, camera.getViewProjection(), getViewBasis(camera));
+					isViewOutdated = true;
+				}
+			}
+			
 			// drag-move selected point
-			if(splineInput.selectedPoint != -1){
+			else if(splineInput.selectedPoint != -1){
 				if(input.getHold(InputPlace)){
 					
 					// position
@@ -213,18 +395,12 @@ int main(int argc, char *argv[]){
 					placeAt[1] *= viewport[1];
 					
 					// move
-					splineInput.movePoint(splineInput.selectedPoint, placeAt[0], placeAt[1]);
-					
-					// update
-					pointBuffer.update(&placeAt[0], sizeof(float) * 2, sizeof(float) * splineInput.selectedPoint * 2);
-					isDataOutdated = true;
+					edits.move(splineInput, splineInput.selectedPoint, placeAt[0], placeAt[1]);
 				}
 				else{
 					
 					// drop
-					(*currentSpline)->constrain(splineInput.selectedPoint, splineInput.points);
-					pointBuffer.update(splineInput.points.data(), sizeof(float) * splineInput.points.size(), 0);
-					isDataOutdated = true;
+					edits.drop(splineInput.selectedPoint);
 					printf("Moved point %i\n", splineInput.selectedPoint);
 					splineInput.setSelectedPoint(-1);
 				}
@@ -248,14 +424,7 @@ int main(int argc, char *argv[]){
 				else if(splineInput.points.size() / 2 < MAX_VERTICES){
 					
 					// push
-					splineInput.pushPoint(placeAt[0], placeAt[1]);
-					(*currentSpline)->constrainPoint(splineInput.points.size() / 2 - 1, -1, splineInput.points);
-					pointDraw.recount(splineInput.points.size() / 2);
-					vectorPointDraw.recount(splineInput.points.size() / 4);
-					
-					// update
-					pointBuffer.update(&splineInput.points[splineInput.points.size() - 2], sizeof(float) * 2, sizeof(float) * (splineInput.points.size() - 2));
-					isDataOutdated = true;
+					edits.push(splineInput, placeAt[0], placeAt[1]);
 					printf("Added point %i\n", splineInput.points.size() / 2);
 				}
 			}
@@ -263,10 +432,7 @@ int main(int argc, char *argv[]){
 			// pop point
 			if(input.getPress(InputRemove)){
 				if(!splineInput.points.empty()){
-					splineInput.popPoint();
-					pointDraw.recount(splineInput.points.size() / 2);
-					vectorPointDraw.recount(splineInput.points.size() / 4);
-					isDataOutdated = true;
+					edits.pop(splineInput);
 					printf("Removed point %i\n", splineInput.points.size() / 2);
 				}
 			}
@@ -275,7 +441,9 @@ int main(int argc, char *argv[]){
 			if(input.getPress(InputSampler)){
 				currentSampler++;
 				if(currentSampler == samplers.end()) currentSampler = samplers.begin();
+				setSamplerTotal(**currentSampler, currentSpline - splines.begin());
 				isDataOutdated = true;
+				isCacheReported = true;
 				printf("Toggled curve sampler\n");
 			}
 			
@@ -283,23 +451,137 @@ int main(int argc, char *argv[]){
 			if(input.getPress(InputSpline)){
 				currentSpline++;
 				if(currentSpline == splines.end()) currentSpline = splines.begin();
-				if(currentSpline - splines.begin() == 0) (*currentSampler)->setTotal(CURVE_MAXIMUM_SAMPLES);
-				else (*currentSampler)->setTotal(SPLINE_MAXIMUM_SAMPLES);
-				(*currentSpline)->constrain(splineInput.points);
-				pointBuffer.update(splineInput.points.data(), sizeof(float) * splineInput.points.size(), 0);
-				isDataOutdated = true;
+				setSamplerTotal(**currentSampler, currentSpline - splines.begin());
+				edits.reconstrain(splineInput.points.size() / 2);
+				isCacheReported = true;
 				printf("Toggled spline type\n");
+				
+				// keyframes were constrained & sampled by the previous spline type
+				if(!keyframes.empty()){
+					keyframes.clear();
+					printf("Cleared keyframes\n");
+				}
+			}
+			
+			// commit point edits, uploading the changed range
+			int editFirst, editLast;
+			if(edits.commit(**currentSpline, splineInput, editFirst, editLast)){
+				if(editFirst <= editLast) pointBuffer.update(&splineInput.points[editFirst * 2], sizeof(float) * (editLast - editFirst + 1) * 2, sizeof(float) * editFirst * 2);
+				pointDraw.recount(splineInput.points.size() / 2);
+				vectorPointDraw.recount(splineInput.points.size() / 4);
+				isDataOutdated = true;
+			}
+			
+			// key current curve: sampled once at constant parameters, so sample i of every keyframe evaluates the same parameter
+			if(input.getPress(InputKeyframe)){
+				setSamplerTotal(samplerConstant, currentSpline - splines.begin());
+				SplineInput keyed;
+				keyed.setSamples((*currentSpline)->computeSamples(splineInput.points, samplerConstant));
+				setSamplerTotal(**currentSampler, currentSpline - splines.begin());
+				if(splineInput.selectedPoint != -1) printf("Keyframe needs moved point dropped\n"); // dragged points are not yet constrained
+				else if(keyframes.size() == MAX_KEYFRAMES) printf("Keyframe limit %i reached\n", MAX_KEYFRAMES);
+				else if(keyed.samplePoints.empty() || keyed.samplePoints.size() > MAX_LINES * 2) printf("Keyframe needs 1 to %i samples\n", MAX_LINES);
+				else if(!keyframes.empty() && (splineInput.points.size() != keyframes[0].points.size() || keyed.samplePoints.size() / 2 != keyframeSamples))
+					printf("Keyframe needs %i points\n", keyframes[0].points.size() / 2);
+				else{
+					keyframePositionBuffer.update(keyed.samplePoints.data(), sizeof(float) * keyed.samplePoints.size(), sizeof(float) * keyframes.size() * MAX_LINES * 2);
+					keyframes.push_back(Keyframe{ keyframes.size() * ANIMATION_KEY_INTERVAL, splineInput.points });
+					keyframeSamples = keyed.samplePoints.size() / 2;
+					if(keyframes.size() == 2) animationStart = std::chrono::steady_clock::now();
+					printf("Added keyframe %i\n", keyframes.size());
+				}
+			}
+			
+			// clear keyframe track
+			if(input.getPress(InputKeyframeClear) && !keyframes.empty()){
+				keyframes.clear();
+				printf("Cleared keyframes\n");
 			}
 			
 			// update sample curve
 			if(isDataOutdated){
-				splineInput.setSamples((*currentSpline)->computeSamples(splineInput.points, **currentSampler));
-				lineDraw.recount(splineInput.samplePoints.size() / 2 - 1);
+				
+				// resample, reusing cached samples unless a point is being dragged
+				int splineIndex = currentSpline - splines.begin();
+				int samplerIndex = currentSampler - samplers.begin();
+				bool isCached = splineInput.selectedPoint == -1;
+				CurveSamples const *cached = isCached ? sampleCache.get(splineInput.points, splineIndex, samplerIndex) : nullptr;
+				if(cached) splineInput.setSamples(CurveSamples(*cached));
+				else{
+					CurveSamples samples = (*currentSpline)->computeSamples(splineInput.points, **currentSampler);
+					splineInput.setSamples(CurveSamples(samples));
+					if(isCached) sampleCache.put(splineInput.points, splineIndex, samplerIndex, std::move(samples), 
+						sizeof(float) * (splineInput.samplePoints.size() + splineInput.sampleVectors.size()));
+				}
+				if(isCacheReported){
+					printf("Sample cache hits %u, misses %u, evictions %u\n", sampleCache.hits, sampleCache.misses, sampleCache.evictions);
+					isCacheReported = false;
+				}
+				
+				// upload
+				lineDraw.recountElements(splineInput.samplePoints.size() / 2);
 				vectorDirectionDraw.recount(splineInput.points.size() / 4);
 				linePositionBuffer.update(splineInput.samplePoints.data(), sizeof(float) * splineInput.samplePoints.size(), 0);
-				lineDirectionBuffer.update(splineInput.sampleVectors.data(), sizeof(float) * splineInput.samplePoints.size(), 0);
-				displayCurve(currentRenderers[0], window);
+				lineProgram.setUniform("sample_count", DataInt(splineInput.samplePoints.size() / 2));
 				isDataOutdated = false;
+				isViewOutdated = true;
+			}
+			
+			// play keyframe track, looping back to the first keyframe; holding a point shows the edited curve instead
+			// keyframe samples are already uploaded, so the line strip only needs the bracketing pair & fraction per frame;
+			// control point & vector overlays are interpolated here, being at most MAX_VERTICES points
+			bool wasAnimated = isAnimated;
+			isAnimated = keyframes.size() > 1 && splineInput.selectedPoint == -1;
+			if(isAnimated){
+				float period = keyframes.back().time + ANIMATION_KEY_INTERVAL;
+				float time = fmod(std::chrono::duration<float>(std::chrono::steady_clock::now() - animationStart).count(), period);
+				keyframeFirst = keyframes.size() - 1;
+				for(int k = 1; k < keyframes.size(); k++) if(time < keyframes[k].time){
+					keyframeFirst = k - 1;
+					break;
+				}
+				keyframeNext = (keyframeFirst + 1) % keyframes.size();
+				float end = keyframeNext == 0 ? period : keyframes[keyframeNext].time;
+				animationTime = (time - keyframes[keyframeFirst].time) / (end - keyframes[keyframeFirst].time);
+				std::vector<float> const &first = keyframes[keyframeFirst].points, &next = keyframes[keyframeNext].points;
+				std::vector<float> points(first.size());
+				for(int i = 0; i < points.size(); i++) points[i] = first[i] + (next[i] - first[i]) * animationTime;
+				pointBuffer.update(points.data(), sizeof(float) * points.size(), 0);
+				pointDraw.recount(points.size() / 2);
+				vectorPointDraw.recount(points.size() / 4);
+				vectorDirectionDraw.recount(points.size() / 4);
+				lineDraw.recountElements(keyframeSamples);
+				setAnimation();
+				isViewOutdated = true;
+			}
+			else if(wasAnimated){ // back to the edited curve
+				pointBuffer.update(splineInput.points.data(), sizeof(float) * splineInput.points.size(), 0);
+				pointDraw.recount(splineInput.points.size() / 2);
+				vectorPointDraw.recount(splineInput.points.size() / 4);
+				vectorDirectionDraw.recount(splineInput.points.size() / 4);
+				lineDraw.recountElements(splineInput.samplePoints.size() / 2);
+				animationTime = 0;
+				setAnimation();
+				isViewOutdated = true;
+			}
+			
+			// export curve: bezier curves up to cubic degree are written natively, other curves as samples
+			// (basis spline pieces' point layout belongs to SplineType_Basis, so they are not written as native cubics)
+			if(input.getPress(InputExport)){
+				std::chrono::steady_clock::time_point exportStart = std::chrono::steady_clock::now();
+				std::vector<float> cubic;
+				if(dynamic_cast<SplineType_Bezier*>(*currentSpline)) cubic = Exporter::bezierToCubic(splineInput.points);
+				bool isWritten = !cubic.empty() ? Exporter::writeSvgCubic(EXPORT_SVG, cubic, LINE_THICKNESS) : Exporter::writeSvg(EXPORT_SVG, splineInput.samplePoints, LINE_THICKNESS);
+				isWritten = Exporter::writeCsv(EXPORT_CSV, splineInput.samplePoints) && isWritten;
+				isWritten = Exporter::writeGcode(EXPORT_GCODE, splineInput.samplePoints, EXPORT_GCODE_SCALE, EXPORT_FEED_RATE) && isWritten;
+				float exportTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - exportStart).count();
+				printf(isWritten ? "Exported curve in %fs\n" : "Failed to export curve after %fs\n", exportTime);
+			}
+			
+			// redraw
+			if(isViewOutdated){
+				displayCurve(currentRenderers[0], window);
+				isViewOutdated = false;
 			}
 		}
 	}
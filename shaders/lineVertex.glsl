@@ -1,21 +1,79 @@
-// line vertex shader: line joint vertices
+// line vertex shader: joined line strip, pulled from sample positions
 
 #version 330 core
 
-layout (location = 0) in vec2 quad;
-layout (location = 1) in vec2 pos0;
-layout (location = 2) in vec2 dir0;
-layout (location = 3) in vec2 pos1;
-layout (location = 4) in vec2 dir1;
+uniform samplerBuffer sample_positions;
+uniform samplerBuffer keyframe_positions;
+uniform int sample_count;
+uniform int is_animated;
+uniform int keyframe_first;
+uniform int keyframe_next;
+uniform float animation_time;
 
 uniform mat4 view_projection;
+uniform vec3 view_axis;
 uniform float line_thickness;
+uniform float miter_limit;
+uniform int line_join; // 0 miter, falling back to bevel past miter_limit; 1 bevel; 2 round
+uniform int join_steps; // outer joint points per sample, at least 2
 
-out vec2 vert_joint;
+vec3 fetch(int i){ // current samples, or interpolated between the bracketing keyframes' samples at the same parameter
+	int j = clamp(i, 0, sample_count - 1);
+	if(is_animated == 0) return texelFetch(sample_positions, j).xyz;
+	return mix(texelFetch(keyframe_positions, keyframe_first + j).xyz, texelFetch(keyframe_positions, keyframe_next + j).xyz, animation_time);
+}
+
+vec3 unit(vec3 v){ // zero-safe normalise for coincident samples
+	float len = length(v);
+	return len > 0 ? v / len : v;
+}
+
+vec3 rotate(vec3 v, float angle){ // about the view axis, for v perpendicular to it
+	return v * cos(angle) + cross(view_axis, v) * sin(angle);
+}
 
 void main(){
-	vec2 position = mix(pos0, pos1, (quad.x + 1) / 2);
-	vec2 direction = mix(dir0, dir1, (quad.x + 1) / 2);
-	vec2 joint = line_thickness * vec2(-direction.y, direction.x) * quad.y;
-	gl_Position = view_projection * vec4(position + joint, 0, 1);
+
+	// per sample: the incoming segment's end pair, a fan of (sample, outer joint point) pairs, then the outgoing segment's start pair,
+	// so each segment is a full-width quad and the outer side of every turn is closed by the joint fan
+	int vertices = 2 * (join_steps + 2);
+	int i = gl_VertexID / vertices;
+	int pair = gl_VertexID % vertices / 2;
+	float side = float(gl_VertexID % 2) * 2 - 1;
+
+	// neighbouring segments, extended past the ends
+	vec3 position = fetch(i);
+	vec3 incoming = position - fetch(i - 1);
+	vec3 outgoing = fetch(i + 1) - position;
+	if(i == 0) incoming = outgoing;
+	if(i == sample_count - 1) outgoing = incoming;
+	incoming = unit(incoming);
+	outgoing = unit(outgoing);
+	if(length(outgoing) == 0) outgoing = incoming;
+	if(length(incoming) == 0) incoming = outgoing;
+
+	// segment normals & signed turn between them, the outer side being opposite the turn
+	vec3 normalIn = unit(cross(view_axis, incoming));
+	vec3 normalOut = unit(cross(view_axis, outgoing));
+	float turn = atan(dot(view_axis, cross(normalIn, normalOut)), dot(normalIn, normalOut));
+	float outer = turn > 0 ? -1. : 1.;
+
+	// segment ends
+	vec3 joint;
+	if(pair == 0) joint = normalIn * side;
+	else if(pair == join_steps + 1) joint = normalOut * side;
+
+	// fan centre
+	else if(side < 0) joint = vec3(0);
+
+	// outer joint points, from the incoming to the outgoing segment's edge
+	else{
+		float t = float(pair - 1) / float(join_steps - 1);
+		float extent = cos(turn / 2);
+		if(line_join == 2) joint = rotate(normalIn, turn * t);
+		else if(line_join == 0 && pair != 1 && pair != join_steps && extent > 0 && 1 / extent <= miter_limit) joint = rotate(normalIn, turn / 2) / extent;
+		else joint = mix(normalIn, normalOut, t);
+		joint *= outer;
+	}
+	gl_Position = view_projection * vec4(position + line_thickness * joint, 1);
 };
\ No newline at end of file
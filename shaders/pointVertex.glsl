@@ -3,14 +3,16 @@
 #version 330 core
 
 layout (location = 0) in vec2 rel;
-layout (location = 1) in vec2 pos;
+layout (location = 1) in vec3 pos;
 
 out vec2 vert_pos;
 
 uniform mat4 view_projection;
+uniform vec3 view_right;
+uniform vec3 view_up;
 uniform float point_radius;
 
 void main(){
-	gl_Position = view_projection * vec4(pos + rel * point_radius, 0, 1);
+	gl_Position = view_projection * vec4(pos + (view_right * rel.x + view_up * rel.y) * point_radius, 1);
 	vert_pos = rel;
 };
\ No newline at end of file
@@ -3,18 +3,19 @@
 #version 330 core
 
 layout (location = 0) in vec2 quad_position;
-layout (location = 1) in vec2 position0;
-layout (location = 2) in vec2 position1;
+layout (location = 1) in vec3 position0;
+layout (location = 2) in vec3 position1;
 
 uniform mat4 view_projection;
+uniform vec3 view_axis;
 uniform float vector_thickness;
 uniform float vector_length;
 
 void main(){
-	vec2 direction = normalize(position1 - position0);
-	vec2 perpendicular = vec2(-direction.y, direction.x);
-	vec2 vertex_position = position0 + 
+	vec3 direction = normalize(position1 - position0);
+	vec3 perpendicular = normalize(cross(view_axis, direction));
+	vec3 vertex_position = position0 + 
 		vector_length * mix(-direction, direction, (quad_position.x + 1) / 2) + 
 		vector_thickness * mix(-perpendicular, perpendicular, (quad_position.y + 1) / 2);
-	gl_Position = view_projection * vec4(vertex_position, 0, 1);
+	gl_Position = view_projection * vec4(vertex_position, 1);
 };
\ No newline at end of file
@@ -0,0 +1,305 @@
+// spline property harness: random & degenerate control polygons checked against the README's stated properties
+// build with FUZZ defined and -fsanitize=fuzzer for a libFuzzer target, otherwise runs seeded random cases
+
+#include "../source/spline.hpp" // curves & splines
+
+#include <stdio.h> // reporting
+#include <stdlib.h> // arguments & budget override
+#include <stdint.h> // fuzzer input
+#include <string.h> // fuzzer input
+#include <cmath> // tolerances
+#include <cfloat> // sample rounding
+#include <chrono> // timing budgets
+#include <random> // case generation
+#include <algorithm> // convex hull
+#include <array> // hull points
+
+// sampler constants, as in main.cpp
+#define SAMPLER_CONSTANT_RESOLUTION 5
+#define SAMPLER_SPATIAL_MAXLENGTH .05f
+#define SAMPLER_CURVATURE_MAXDIST .05f
+#define SAMPLER_CURVATURE_MAXANGLE 5.f
+#define CURVE_MAXIMUM_SAMPLES 20
+#define SPLINE_MAXIMUM_SAMPLES 8
+
+// harness constants
+#define TEST_CASES 2000
+#define TEST_MAX_POINTS 32
+#define TEST_TOLERANCE 1e-4
+#define TEST_SAMPLE_LIMIT(points) (CURVE_MAXIMUM_SAMPLES * ((points) + 1))
+
+// continuity constants: finite differences of constant-sampled curves are compared between a resolution and its double,
+// orders 0 & 1 at a fine resolution, order 2 coarser as third differences of float samples soon drown in rounding
+#define CONTINUITY_REFINEMENT 32
+#define CONTINUITY_REFINEMENT_C2 2
+#define CONTINUITY_RATIO .7 // continuous measures halve, discontinuous ones keep their size
+#define CONTINUITY_TOLERANCE 1e-3
+#define CONTINUITY_RESOLUTION 1e-4 // smallest resolvable step relative to extent, below which float rounding dominates
+#define CONTINUITY_RESOLVED 100 // second differences measured for order 2 above this multiple of float rounding
+
+// wall-clock budget per kernel call, a coarse backstop behind the deterministic sample-count limit;
+// overridden by the TEST_BUDGET_MS environment variable (0 disables), and scaled for sanitised fuzzing builds
+#ifndef TEST_BUDGET_MS
+#define TEST_BUDGET_MS 50.
+#endif
+#ifdef FUZZ
+#define TEST_BUDGET_SCALE 20.
+#else
+#define TEST_BUDGET_SCALE 1.
+#endif
+
+// polygon kinds
+enum PolygonKind{
+	PolygonRandom, PolygonCollinear, PolygonCoincident, PolygonClustered, PolygonHuge, PolygonTiny,
+	PolygonKinds
+};
+
+struct Harness{
+
+	// samplers
+	CurveSampler_Constant samplerConstant;
+	CurveSampler_Spatial samplerSpatial;
+	CurveSampler_Curvature samplerCurvature;
+	std::vector<CurveSampler*> samplers;
+
+	// splines, with the continuity order each states at its knots (C-infinity checked up to C2, -1 for the knotless bezier curve)
+	std::vector<float> bezierCubicBasis;
+	SplineType_Bezier bezierCurve;
+	SplineType_Basis cubicSpline, handledSpline, naturalSpline, infiniteSpline, cardinalSpline;
+	std::vector<SplineType*> splines;
+	std::vector<int> continuities;
+
+	double budget; // milliseconds, 0 when disabled
+
+	Harness() :
+		samplerConstant(SAMPLER_CONSTANT_RESOLUTION, CURVE_MAXIMUM_SAMPLES),
+		samplerSpatial(SAMPLER_SPATIAL_MAXLENGTH, CURVE_MAXIMUM_SAMPLES),
+		samplerCurvature(SAMPLER_CURVATURE_MAXANGLE, SAMPLER_CURVATURE_MAXDIST, CURVE_MAXIMUM_SAMPLES),
+		samplers{ &samplerConstant, &samplerSpatial, &samplerCurvature },
+		bezierCubicBasis(bezierBasis(2 + 2)),
+		cubicSpline(std::vector<float>(bezierCubicBasis), 2, 0),
+		handledSpline(std::vector<float>(bezierCubicBasis), 2, 1),
+		naturalSpline(std::vector<float>(bezierCubicBasis), 2, 2),
+		infiniteSpline(std::vector<float>(bezierCubicBasis), 2, 3),
+		cardinalSpline(std::vector<float>(bezierCubicBasis), 2, 1, true),
+		splines{ &bezierCurve, &cubicSpline, &handledSpline, &naturalSpline, &infiniteSpline, &cardinalSpline },
+		continuities{ -1, 0, 1, 2, 2, 1 },
+		budget(TEST_BUDGET_MS * TEST_BUDGET_SCALE) {
+		const char *override = getenv("TEST_BUDGET_MS");
+		if(override) budget = atof(override) * TEST_BUDGET_SCALE;
+	}
+
+	// checks one polygon against one spline type & sampler, printing the first failed property
+	bool check(std::vector<float> const &polygon, int spline, int sampler){
+		SplineInput input;
+		input.points = polygon;
+		samplers[sampler]->setTotal(spline == 0 ? CURVE_MAXIMUM_SAMPLES : SPLINE_MAXIMUM_SAMPLES);
+
+		// constrain within budget, idempotently: continuity is enforced by moving points, so constrained points must stay put
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		splines[spline]->constrain(input.points);
+		if(isOverBudget(start)) return fail("constrain exceeded time budget", polygon, spline, sampler);
+		std::vector<float> reconstrained(input.points);
+		splines[spline]->constrain(reconstrained);
+		double tolerance = TEST_TOLERANCE * std::max(1., extent(input.points));
+		if(reconstrained.size() != input.points.size()) return fail("constrain changed a constrained point count", polygon, spline, sampler);
+		for(int i = 0; i < input.points.size(); i++)
+			if(!(std::fabs(reconstrained[i] - input.points[i]) <= tolerance)) return fail("constrain not idempotent", polygon, spline, sampler);
+
+		// sample within budget & limits
+		start = std::chrono::steady_clock::now();
+		input.setSamples(splines[spline]->computeSamples(input.points, *samplers[sampler]));
+		if(isOverBudget(start)) return fail("computeSamples exceeded time budget", polygon, spline, sampler);
+		std::vector<float> const &samples = input.samplePoints;
+		if(samples.size() / 2 > TEST_SAMPLE_LIMIT(input.points.size() / 2)) return fail("sample count blew up", polygon, spline, sampler);
+		for(float x : samples) if(!std::isfinite(x)) return fail("non-finite sample", polygon, spline, sampler);
+		for(float x : input.sampleVectors) if(!std::isfinite(x)) return fail("non-finite sample vector", polygon, spline, sampler);
+		if(input.points.size() < 4 || samples.size() < 2) return true;
+
+		// endpoint interpolation of the bezier curve
+		if(spline == 0){
+			int last = input.points.size() - 2, lastSample = samples.size() - 2;
+			if(distance(samples[0], samples[1], input.points[0], input.points[1]) > tolerance) return fail("curve does not start on first point", polygon, spline, sampler);
+			if(distance(samples[lastSample], samples[lastSample + 1], input.points[last], input.points[last + 1]) > tolerance) return fail("curve does not end on last point", polygon, spline, sampler);
+		}
+
+		// convex hull bound: every piece lies within its own points' hull, so within the whole polygon's hull
+		std::vector<std::array<double,2>> hull = convexHull(input.points);
+		for(int i = 0; i < samples.size(); i += 2)
+			if(hullDistance(hull, samples[i], samples[i + 1]) > tolerance) return fail("sample outside control point convex hull", polygon, spline, sampler);
+
+		// continuity at knots, once per spline type
+		if(sampler != 0 || continuities[spline] < 0) return true;
+		std::array<double,3> coarse = jumps(input.points, spline, CONTINUITY_REFINEMENT), fine = jumps(input.points, spline, CONTINUITY_REFINEMENT * 2);
+		std::array<double,3> coarseC2 = jumps(input.points, spline, CONTINUITY_REFINEMENT_C2), fineC2 = jumps(input.points, spline, CONTINUITY_REFINEMENT_C2 * 2);
+		coarse[2] = coarseC2[2];
+		fine[2] = fineC2[2];
+		const char *discontinuities[] = { "curve not C0 at a knot", "curve not C1 at a knot", "curve not C2 at a knot" };
+		for(int order = 0; order <= continuities[spline]; order++)
+			if(fine[order] > CONTINUITY_RATIO * coarse[order] + CONTINUITY_TOLERANCE) return fail(discontinuities[order], polygon, spline, sampler);
+		return true;
+	}
+
+	// scale-free finite differences of samples taken at fixed parameter intervals (the constant sampler, per the README), for orders 0 to 2:
+	// largest step over extent, largest second difference over largest step, largest third over largest second difference;
+	// with step h each shrinks as h where the curve is continuous to that order, but keeps its size across a knot where it is not;
+	// repeated knot samples are dropped as they carry no parameter step, and curves too short or straight to resolve in float precision are not measured
+	std::array<double,3> jumps(std::vector<float> const &points, int spline, int refinement){
+		CurveSampler_Constant refined(SAMPLER_CONSTANT_RESOLUTION * refinement, CURVE_MAXIMUM_SAMPLES * refinement);
+		refined.setTotal((spline == 0 ? CURVE_MAXIMUM_SAMPLES : SPLINE_MAXIMUM_SAMPLES) * refinement);
+		SplineInput input;
+		input.setSamples(splines[spline]->computeSamples(points, refined));
+		std::array<double,3> largest{ 0, 0, 0 };
+		double size = extent(points), differences[3] = { 0, 0, 0 };
+		double rounding = 64 * FLT_EPSILON * size; // float evaluation error carried into the differences
+		std::vector<std::array<double,2>> samples, steps;
+		for(int i = 2; i + 1 < input.samplePoints.size(); i += 2){
+			samples.push_back({ input.samplePoints[i] - input.samplePoints[i - 2], input.samplePoints[i + 1] - input.samplePoints[i - 1] });
+			differences[0] = std::max(differences[0], std::hypot(samples.back()[0], samples.back()[1]));
+		}
+		for(int i = 0; i < samples.size(); i++){ // the shortest of its neighbours, a step within rounding repeats a knot sample when the steps around it run smoother without it;
+			// through a slow stretch they run alike either way, and through a turn they pass evenly through it
+			double length = std::hypot(samples[i][0], samples[i][1]);
+			bool isRepeated = length <= rounding && i >= 2 && i + 2 < samples.size()
+				&& length <= std::hypot(samples[i - 1][0], samples[i - 1][1]) && length < std::hypot(samples[i + 1][0], samples[i + 1][1]);
+			if(isRepeated) isRepeated = kink({ samples[i - 2], samples[i - 1], samples[i + 1], samples[i + 2] }) < kink({ samples[i - 2], samples[i - 1], samples[i], samples[i + 1], samples[i + 2] });
+			if(!isRepeated) steps.push_back(samples[i]);
+		}
+		for(int i = 0; i < steps.size(); i++){
+			if(i > 0) differences[1] = std::max(differences[1], std::hypot(steps[i][0] - steps[i - 1][0], steps[i][1] - steps[i - 1][1]));
+			if(i > 1) differences[2] = std::max(differences[2], std::hypot(steps[i][0] - 2 * steps[i - 1][0] + steps[i - 2][0], steps[i][1] - 2 * steps[i - 1][1] + steps[i - 2][1]));
+		}
+		if(differences[0] <= size * CONTINUITY_RESOLUTION) return largest;
+		largest[0] = differences[0] / size;
+		largest[1] = std::max(0., differences[1] - rounding) / differences[0];
+		if(differences[1] > rounding * CONTINUITY_RESOLVED) largest[2] = std::max(0., differences[2] - rounding) / differences[1];
+		return largest;
+	}
+
+	static double kink(std::vector<std::array<double,2>> const &steps){ // largest third difference of a few steps
+		double largest = 0;
+		for(int i = 3; i < steps.size(); i++)
+			largest = std::max(largest, std::hypot(steps[i][0] - 3 * steps[i - 1][0] + 3 * steps[i - 2][0] - steps[i - 3][0], steps[i][1] - 3 * steps[i - 1][1] + 3 * steps[i - 2][1] - steps[i - 3][1]));
+		return largest;
+	}
+
+	bool isOverBudget(std::chrono::steady_clock::time_point start){
+		return budget > 0 && std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() > budget;
+	}
+
+	static double extent(std::vector<float> const &points){
+		double largest = 0;
+		for(float x : points) largest = std::max(largest, (double)std::fabs(x));
+		return largest;
+	}
+
+	static double distance(double ax, double ay, double bx, double by){
+		return std::hypot(ax - bx, ay - by);
+	}
+
+	static double cross(std::array<double,2> const &o, std::array<double,2> const &a, std::array<double,2> const &b){
+		return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0]);
+	}
+
+	static std::vector<std::array<double,2>> convexHull(std::vector<float> const &points){ // monotone chain, counter-clockwise
+		std::vector<std::array<double,2>> sorted, hull;
+		for(int i = 0; i + 1 < points.size(); i += 2) sorted.push_back({ points[i], points[i + 1] });
+		std::sort(sorted.begin(), sorted.end());
+		sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+		if(sorted.size() < 3) return sorted;
+		for(int pass = 0; pass < 2; pass++){
+			int base = hull.size();
+			for(std::array<double,2> const &p : sorted){
+				while(hull.size() >= base + 2 && cross(hull[hull.size() - 2], hull.back(), p) <= 0) hull.pop_back();
+				hull.push_back(p);
+			}
+			hull.pop_back();
+			std::reverse(sorted.begin(), sorted.end());
+		}
+		return hull;
+	}
+
+	static double hullDistance(std::vector<std::array<double,2>> const &hull, double x, double y){ // 0 inside
+		std::array<double,2> p{ x, y };
+		if(hull.size() == 1) return distance(x, y, hull[0][0], hull[0][1]);
+		bool isInside = hull.size() >= 3;
+		double nearest = INFINITY;
+		for(int i = 0; i < hull.size(); i++){
+			std::array<double,2> const &a = hull[i], &b = hull[(i + 1) % hull.size()];
+			if(cross(a, b, p) < 0) isInside = false;
+			double dx = b[0] - a[0], dy = b[1] - a[1];
+			double t = std::max(0., std::min(1., ((x - a[0]) * dx + (y - a[1]) * dy) / (dx * dx + dy * dy)));
+			nearest = std::min(nearest, distance(x, y, a[0] + t * dx, a[1] + t * dy));
+		}
+		return isInside ? 0 : nearest;
+	}
+
+	bool fail(const char *property, std::vector<float> const &polygon, int spline, int sampler){
+		printf("FAIL: %s (spline %i, sampler %i, %i points):", property, spline, sampler, (int)polygon.size() / 2);
+		for(int i = 0; i + 1 < polygon.size(); i += 2) printf(" (%g, %g)", polygon[i], polygon[i + 1]);
+		printf("\n");
+		return false;
+	}
+};
+
+std::vector<float> generatePolygon(std::mt19937 &random, PolygonKind kind){
+	std::uniform_real_distribution<float> unit(-1.f, 1.f);
+	int count = std::uniform_int_distribution<int>(0, TEST_MAX_POINTS)(random);
+	float scale = kind == PolygonHuge ? 1e6f : kind == PolygonTiny ? 1e-6f : 1.f;
+	float origin[2] = { unit(random), unit(random) }, direction[2] = { unit(random), unit(random) };
+	std::vector<float> polygon;
+	for(int i = 0; i < count; i++){
+		float t = unit(random);
+		switch(kind){
+			case PolygonCollinear:
+				polygon.push_back(origin[0] + direction[0] * t);
+				polygon.push_back(origin[1] + direction[1] * t);
+				break;
+			case PolygonCoincident:
+				polygon.push_back(origin[0]);
+				polygon.push_back(origin[1]);
+				break;
+			case PolygonClustered:
+				polygon.push_back(origin[0] + (i % 3 == 0 ? 0 : t * 1e-7f));
+				polygon.push_back(origin[1]);
+				break;
+			default:
+				polygon.push_back(unit(random) * scale);
+				polygon.push_back(unit(random) * scale);
+				break;
+		}
+	}
+	return polygon;
+}
+
+#ifdef FUZZ
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const *data, size_t size){
+	static Harness harness;
+	if(size < 1) return 0;
+	int spline = data[0] % harness.splines.size(), sampler = (data[0] / harness.splines.size()) % harness.samplers.size();
+	std::vector<float> polygon((size - 1) / sizeof(float) & ~(size_t)1);
+	memcpy(polygon.data(), data + 1, polygon.size() * sizeof(float));
+	for(float x : polygon) if(!std::isfinite(x)) return 0;
+	if(polygon.size() / 2 > TEST_MAX_POINTS) polygon.resize(TEST_MAX_POINTS * 2);
+	if(!harness.check(polygon, spline, sampler)) abort();
+	return 0;
+}
+
+#else
+
+int main(int argc, char *argv[]){
+	Harness harness;
+	std::mt19937 random(argc > 1 ? atoi(argv[1]) : 1);
+	int failures = 0;
+	for(int c = 0; c < TEST_CASES; c++){
+		std::vector<float> polygon = generatePolygon(random, (PolygonKind)(c % PolygonKinds));
+		for(int spline = 0; spline < harness.splines.size(); spline++)
+			for(int sampler = 0; sampler < harness.samplers.size(); sampler++)
+				failures += !harness.check(polygon, spline, sampler);
+	}
+	printf("%i failures over %i polygons\n", failures, TEST_CASES);
+	return failures != 0;
+}
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef HEADER_EXPORTER
+#define HEADER_EXPORTER
+
+#include <fstream> // file writing
+#include <string> // chunk formatting
+#include <vector> // chunk storage
+#include <thread> // parallel formatting
+#include <algorithm> // bounds
+#include <stdio.h> // number formatting
+
+#define EXPORT_CHUNK_POINTS 65536
+#define EXPORT_FILE_BUFFER (1 << 20)
+
+struct Exporter{
+
+	// sampled polyline as comma separated x,y rows
+	static bool writeCsv(std::string const &fileName, std::vector<float> const &samplePoints){
+		return writeChunked(fileName, "x,y\n", samplePoints.size() / 2, "",
+			[&samplePoints](std::string &out, std::size_t i){
+				append(out, "%.9g,%.9g\n", samplePoints[i * 2], samplePoints[i * 2 + 1]);
+			});
+	}
+
+	// sampled polyline as linear tool moves, scaled from curve units to millimetres
+	static bool writeGcode(std::string const &fileName, std::vector<float> const &samplePoints, float scale, float feedRate){
+		std::string header = "G21\nG90\n";
+		append(header, "F%g\n", feedRate);
+		return writeChunked(fileName, header, samplePoints.size() / 2, "M2\n",
+			[&samplePoints, scale](std::string &out, std::size_t i){
+				append(out, i == 0 ? "G0 X%.4f Y%.4f\n" : "G1 X%.4f Y%.4f\n", samplePoints[i * 2] * scale, samplePoints[i * 2 + 1] * scale);
+			});
+	}
+
+	// sampled polyline as an svg path
+	static bool writeSvg(std::string const &fileName, std::vector<float> const &samplePoints, float strokeWidth){
+		return writeChunked(fileName, svgHeader(samplePoints, strokeWidth), samplePoints.size() / 2, svgFooter(),
+			[&samplePoints](std::string &out, std::size_t i){
+				append(out, i == 0 ? "M%.9g %.9g" : " L%.9g %.9g", samplePoints[i * 2], samplePoints[i * 2 + 1]);
+			});
+	}
+
+	// cubic bezier pieces of four control points each as native svg curves, without sampling; fails on partial pieces
+	static bool writeSvgCubic(std::string const &fileName, std::vector<float> const &points, float strokeWidth){
+		if(points.empty() || points.size() % 8 != 0) return false;
+		return writeChunked(fileName, svgHeader(points, strokeWidth), points.size() / 8, svgFooter(),
+			[&points](std::string &out, std::size_t i){
+				float const *p = &points[i * 8];
+				append(out, "%sM%.9g %.9g C%.9g %.9g %.9g %.9g %.9g %.9g", i == 0 ? "" : " ", p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
+			});
+	}
+
+	// single bezier curve of up to cubic degree as one cubic piece, by exact degree elevation; empty when not representable
+	static std::vector<float> bezierToCubic(std::vector<float> const &points){
+		std::vector<float> cubic;
+		if(points.size() == 8) cubic = points;
+		else if(points.size() == 6) cubic = { // quadratic
+			points[0], points[1], 
+			points[0] + (points[2] - points[0]) * 2.f / 3.f, points[1] + (points[3] - points[1]) * 2.f / 3.f, 
+			points[4] + (points[2] - points[4]) * 2.f / 3.f, points[5] + (points[3] - points[5]) * 2.f / 3.f, 
+			points[4], points[5]};
+		else if(points.size() == 4) cubic = { // linear
+			points[0], points[1], 
+			points[0] + (points[2] - points[0]) / 3.f, points[1] + (points[3] - points[1]) / 3.f, 
+			points[0] + (points[2] - points[0]) * 2.f / 3.f, points[1] + (points[3] - points[1]) * 2.f / 3.f, 
+			points[2], points[3]};
+		return cubic;
+	}
+
+	// formatting, with csv & svg coordinates at the 9 significant digits that round-trip any float
+	template<typename... Args>
+	static void append(std::string &out, const char *format, Args... args){
+		char text[256];
+		int length = snprintf(text, sizeof(text), format, args...);
+		if(length > 0) out.append(text, std::min<std::size_t>(length, sizeof(text) - 1));
+	}
+
+	static std::string svgHeader(std::vector<float> const &points, float strokeWidth){
+		float bounds[4] = { 0, 0, 0, 0 }; // minimum x & y, maximum x & y
+		for(std::size_t i = 0; i + 1 < points.size(); i += 2){
+			if(i == 0 || points[i] < bounds[0]) bounds[0] = points[i];
+			if(i == 0 || points[i + 1] < bounds[1]) bounds[1] = points[i + 1];
+			if(i == 0 || points[i] > bounds[2]) bounds[2] = points[i];
+			if(i == 0 || points[i + 1] > bounds[3]) bounds[3] = points[i + 1];
+		}
+		std::string header = "<svg xmlns=\"http://www.w3.org/2000/svg\" ";
+		append(header, "viewBox=\"%.9g %.9g %.9g %.9g\">\n", bounds[0] - strokeWidth, -bounds[3] - strokeWidth,
+			bounds[2] - bounds[0] + strokeWidth * 2, bounds[3] - bounds[1] + strokeWidth * 2);
+		append(header, "<path transform=\"scale(1,-1)\" fill=\"none\" stroke=\"black\" stroke-width=\"%.9g\" d=\"", strokeWidth);
+		return header;
+	}
+
+	static std::string svgFooter(){
+		return "\"/>\n</svg>\n";
+	}
+
+	// chunks are formatted in parallel and written in order, keeping one chunk per thread in memory
+	template<typename Format>
+	static bool writeChunked(std::string const &fileName, std::string const &header, std::size_t count, std::string const &footer, Format format){
+		std::vector<char> fileBuffer(EXPORT_FILE_BUFFER);
+		std::ofstream file;
+		file.rdbuf()->pubsetbuf(fileBuffer.data(), fileBuffer.size());
+		file.open(fileName, std::ios::binary);
+		if(!file) return false;
+		file << header;
+		unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+		std::vector<std::string> chunks(workers);
+		for(std::size_t start = 0; start < count; start += (std::size_t)EXPORT_CHUNK_POINTS * workers){
+			std::vector<std::thread> threads;
+			for(unsigned w = 0; w < workers; w++){
+				std::size_t begin = std::min(count, start + (std::size_t)EXPORT_CHUNK_POINTS * w);
+				std::size_t end = std::min(count, begin + EXPORT_CHUNK_POINTS);
+				chunks[w].clear();
+				if(begin < end) threads.emplace_back([&chunks, &format, w, begin, end]{
+					for(std::size_t i = begin; i < end; i++) format(chunks[w], i);
+				});
+			}
+			for(std::thread &thread : threads) thread.join();
+			for(std::string const &chunk : chunks) file << chunk;
+		}
+		file << footer;
+		file.close();
+		return !file.fail();
+	}
+};
+
+#endif
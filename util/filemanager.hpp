@@ -3,6 +3,7 @@
 
 #include <fstream> // file accessing
 #include <sstream> // structured file extracting
+#include <future> // asynchronous loading
 
 struct FileManager{
 	static std::string get(std::string const &fileName){
@@ -14,6 +15,9 @@ struct FileManager{
 		file.close();
 		return data.str();
 	}
+	static std::future<std::string> load(std::string const &fileName){ // read on a worker thread
+		return std::async(std::launch::async, get, fileName);
+	}
 };
 
 #endif
\ No newline at end of file
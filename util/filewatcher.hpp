@@ -0,0 +1,71 @@
+#ifndef HEADER_FILEWATCHER
+#define HEADER_FILEWATCHER
+
+#include "filemanager.hpp" // file reading
+
+#include <filesystem> // modification times
+#include <thread> // watching
+#include <mutex> // change queue
+#include <condition_variable> // prompt stopping
+#include <chrono> // polling interval
+#include <vector> // watched files
+#include <utility> // change pairs
+
+// polls files for modification on a worker thread, reading changed contents off the main thread
+struct FileWatcher{
+	std::vector<std::string> files;
+	std::vector<std::filesystem::file_time_type> times;
+	std::vector<std::pair<std::string, std::string>> changes; // file name, contents
+	std::chrono::milliseconds interval;
+	std::mutex mutex;
+	std::condition_variable wake;
+	bool isWatching;
+	std::thread thread;
+
+	FileWatcher(std::vector<std::string> const &f, int intervalMs) : files{f}, interval{intervalMs}, isWatching{true} {
+		for(std::string const &file : files) times.push_back(modified(file));
+		thread = std::thread(&FileWatcher::watch, this);
+	}
+
+	~FileWatcher(){
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			isWatching = false;
+		}
+		wake.notify_all();
+		thread.join();
+	}
+
+	static std::filesystem::file_time_type modified(std::string const &file){
+		std::error_code error;
+		std::filesystem::file_time_type time = std::filesystem::last_write_time(file, error);
+		return error ? std::filesystem::file_time_type::min() : time;
+	}
+
+	void watch(){
+		std::unique_lock<std::mutex> lock(mutex);
+		while(!wake.wait_for(lock, interval, [this]{ return !isWatching; })){
+			lock.unlock();
+			for(int i = 0; i < files.size(); i++){
+				std::filesystem::file_time_type time = modified(files[i]);
+				if(time == times[i]) continue;
+				times[i] = time;
+				std::string contents = FileManager::get(files[i]);
+				std::lock_guard<std::mutex> changeLock(mutex);
+				changes.emplace_back(files[i], std::move(contents));
+			}
+			lock.lock();
+		}
+	}
+
+	bool poll(std::string &file, std::string &contents){ // non-blocking, for use between frames
+		std::lock_guard<std::mutex> lock(mutex);
+		if(changes.empty()) return false;
+		file = std::move(changes.front().first);
+		contents = std::move(changes.front().second);
+		changes.erase(changes.begin());
+		return true;
+	}
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef HEADER_POINTEDITS
+#define HEADER_POINTEDITS
+
+#include "../source/spline.hpp" // control points & constraints
+
+#include <vector> // pending edits
+#include <algorithm> // edit ranges
+#include <climits> // edit ranges
+
+// control point edit transaction on a SplineInput: inserts, moves & removes change the points as they come,
+// constraints are deferred to commit, which runs one constraint pass and reports the point range to upload
+struct PointEdits{
+	std::vector<int> placed, dropped; // points awaiting constraint
+	int first, last; // changed point range
+	bool isReconstrained, isOutdated;
+
+	PointEdits(){ clear(); }
+
+	void clear(){
+		placed.clear();
+		dropped.clear();
+		first = INT_MAX;
+		last = -1;
+		isReconstrained = isOutdated = false;
+	}
+
+	void mark(int i){ // changed without constraint
+		first = std::min(first, i);
+		last = std::max(last, i);
+		isOutdated = true;
+	}
+
+	// edits
+	void push(SplineInput &input, float x, float y){ // constrained on commit
+		input.pushPoint(x, y);
+		placed.push_back(input.points.size() / 2 - 1);
+		mark(input.points.size() / 2 - 1);
+	}
+	void move(SplineInput &input, int i, float x, float y){ // held, unconstrained until dropped
+		input.movePoint(i, x, y);
+		mark(i);
+	}
+	void drop(int i){ // moved and released, constrained on commit
+		if(std::find(dropped.begin(), dropped.end(), i) == dropped.end()) dropped.push_back(i);
+		mark(i);
+	}
+	void pop(SplineInput &input){
+		input.popPoint();
+		isOutdated = true;
+	}
+	void reconstrain(int n){ // spline type changed
+		isReconstrained = true;
+		if(n > 0){
+			mark(0);
+			mark(n - 1);
+		}
+	}
+
+	// constrains pending edits, giving the changed point range to upload (empty when first > last), false when nothing changed
+	// a lone insert or drop is constrained locally; several merge into one pass over all points, which leaves constrained points in place
+	bool commit(SplineType &spline, SplineInput &input, int &changedFirst, int &changedLast){
+		if(!isOutdated) return false;
+		int n = input.points.size() / 2;
+		placed.erase(std::remove_if(placed.begin(), placed.end(), [n](int i){ return i >= n; }), placed.end());
+		dropped.erase(std::remove_if(dropped.begin(), dropped.end(), [n](int i){ return i >= n; }), dropped.end());
+
+		// constrain
+		if(isReconstrained || placed.size() + dropped.size() > 1) spline.constrain(input.points);
+		else if(!placed.empty()) spline.constrainPoint(placed[0], -1, input.points);
+		else if(!dropped.empty()) spline.constrain(dropped[0], input.points);
+
+		// a drop or full pass may move other points
+		if(isReconstrained || !dropped.empty() || placed.size() > 1){
+			first = 0;
+			last = n - 1;
+		}
+		changedFirst = first;
+		changedLast = std::min(last, n - 1);
+		clear();
+		return true;
+	}
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef HEADER_SAMPLECACHE
+#define HEADER_SAMPLECACHE
+
+#include <vector> // sample storage
+#include <list> // recency order
+#include <unordered_map> // key lookup
+#include <cstdint> // key hashing
+#include <iterator> // eviction
+
+// least recently used cache of sampled curves, keyed by control points, spline type & sampler
+// stores samples as computed, so hits pass through the same setter as fresh samples
+template<typename Samples>
+struct SampleCache{
+
+	struct Entry{
+		std::uint64_t key;
+		std::vector<float> points;
+		int spline, sampler;
+		Samples samples;
+		std::size_t sampleBytes; // reported by the caller, as samples are opaque here
+		std::size_t size() const {
+			return sizeof(Entry) + sizeof(float) * points.size() + sampleBytes;
+		}
+	};
+	typedef typename std::list<Entry>::iterator EntryIterator;
+
+	// storage
+	std::list<Entry> entries; // most recent first
+	std::unordered_map<std::uint64_t, EntryIterator> lookup;
+	std::size_t budget, used;
+
+	// statistics
+	unsigned hits, misses, evictions;
+
+	SampleCache(std::size_t b) : budget{b}, used{0}, hits{0}, misses{0}, evictions{0} {}
+
+	static std::uint64_t hash(std::vector<float> const &points, int spline, int sampler){ // FNV-1a
+		std::uint64_t h = 14695981039346656037ull;
+		auto mix = [&h](void const *data, std::size_t size){
+			unsigned char const *bytes = (unsigned char const*)data;
+			for(std::size_t i = 0; i < size; i++) h = (h ^ bytes[i]) * 1099511628211ull;
+		};
+		mix(&spline, sizeof(int));
+		mix(&sampler, sizeof(int));
+		if(!points.empty()) mix(points.data(), sizeof(float) * points.size());
+		return h;
+	}
+
+	Samples const *get(std::vector<float> const &points, int spline, int sampler){ // null on miss
+		typename std::unordered_map<std::uint64_t, EntryIterator>::iterator found = lookup.find(hash(points, spline, sampler));
+		if(found == lookup.end() || found->second->spline != spline || found->second->sampler != sampler || found->second->points != points){
+			misses++;
+			return nullptr;
+		}
+		entries.splice(entries.begin(), entries, found->second);
+		hits++;
+		return &found->second->samples;
+	}
+
+	void put(std::vector<float> const &points, int spline, int sampler, Samples samples, std::size_t sampleBytes){
+		std::uint64_t key = hash(points, spline, sampler);
+		typename std::unordered_map<std::uint64_t, EntryIterator>::iterator found = lookup.find(key);
+		if(found != lookup.end()) erase(found->second);
+		Entry entry{key, points, spline, sampler, std::move(samples), sampleBytes};
+		if(entry.size() > budget) return;
+		used += entry.size();
+		entries.push_front(std::move(entry));
+		lookup[key] = entries.begin();
+		while(used > budget){
+			erase(std::prev(entries.end()));
+			evictions++;
+		}
+	}
+
+	void clear(){
+		entries.clear();
+		lookup.clear();
+		used = 0;
+	}
+
+	void erase(EntryIterator entry){
+		used -= entry->size();
+		lookup.erase(entry->key);
+		entries.erase(entry);
+	}
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef HEADER_SPLINEBATCH
+#define HEADER_SPLINEBATCH
+
+#include "../source/spline.hpp" // spline constraints
+
+#include <vector> // packed splines
+#include <thread> // worker pool
+#include <mutex> // job hand-off
+#include <condition_variable> // job hand-off
+#include <functional> // jobs
+#include <atomic> // work distribution
+#include <algorithm> // pool size
+
+// constrains many independent splines of one type, packed into a single point array, on a pool of threads kept for the batch's lifetime
+struct SplineBatch{
+	std::vector<std::thread> workers; // the calling thread works alongside
+	std::mutex mutex;
+	std::condition_variable wake, finished;
+	std::function<void()> job;
+	unsigned generation, active;
+	bool isRunning;
+
+	SplineBatch(unsigned threads) : generation{0}, active{0}, isRunning{true} {
+		for(unsigned t = 1; t < std::max(1u, threads); t++) workers.emplace_back(&SplineBatch::serve, this);
+	}
+
+	~SplineBatch(){
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			isRunning = false;
+		}
+		wake.notify_all();
+		for(std::thread &worker : workers) worker.join();
+	}
+
+	void serve(){
+		unsigned seen = 0;
+		std::unique_lock<std::mutex> lock(mutex);
+		while(true){
+			wake.wait(lock, [&]{ return !isRunning || generation != seen; });
+			if(!isRunning) return;
+			seen = generation;
+			lock.unlock();
+			job();
+			lock.lock();
+			if(--active == 0) finished.notify_all();
+		}
+	}
+
+	void run(std::function<void()> const &j){ // on every pool thread & the caller, returning once all are done
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = j;
+			active = workers.size();
+			generation++;
+		}
+		wake.notify_all();
+		j();
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [this]{ return active == 0; });
+	}
+
+	// offsets hold each spline's first coordinate index followed by the packed size, and are rewritten if a constraint changes a spline's length
+	// each thread constrains with its own copy of the spline type, so Spline must be a concrete, copyable type whose copies share no mutable state;
+	// results are written back by spline index, so they do not depend on thread count or scheduling
+	template<typename Spline>
+	void constrain(Spline const &spline, std::vector<float> &points, std::vector<std::size_t> &offsets){
+		if(offsets.size() < 2) return;
+		std::size_t count = offsets.size() - 1;
+		std::vector<std::vector<float>> results(count);
+
+		// constrain
+		std::atomic<std::size_t> next(0);
+		run([&](){
+			Spline local(spline);
+			for(std::size_t i; (i = next++) < count;){
+				results[i].assign(points.begin() + offsets[i], points.begin() + offsets[i + 1]);
+				local.constrain(results[i]);
+			}
+		});
+
+		// write back, repacking only when lengths changed
+		bool isResized = false;
+		for(std::size_t i = 0; i < count; i++) isResized = isResized || results[i].size() != offsets[i + 1] - offsets[i];
+		if(!isResized){
+			for(std::size_t i = 0; i < count; i++) std::copy(results[i].begin(), results[i].end(), points.begin() + offsets[i]);
+			return;
+		}
+		points.clear();
+		for(std::size_t i = 0; i < count; i++){
+			offsets[i] = points.size();
+			points.insert(points.end(), results[i].begin(), results[i].end());
+		}
+		offsets[count] = points.size();
+	}
+};
+
+#endif